@@ -24,6 +24,7 @@ BlueDot_BME280_TSL2591::BlueDot_BME280_TSL2591()
 	parameter.tempOutsideFahrenheit = 999;
 	parameter.integration;
 	parameter.gain;
+	t_fine = 0;
 
 }
 
@@ -348,6 +349,16 @@ void BlueDot_BME280_TSL2591::writeCTRLMeas(void)
 //##########################################################################
 float BlueDot_BME280_TSL2591::readPressure(void)
 {
+	//The pressure is calculated in fixed-point by readPressure_Fixed (in Pa)
+	//Here we only convert it to hPa
+	
+	return (float)readPressure_Fixed()/100;
+}
+//##########################################################################
+int32_t BlueDot_BME280_TSL2591::readPressure_Fixed(void)
+{
+	//Returns the pressure as an integer in Pa (i.e. 96386 = 963.86 hPa)
+	
 	if (parameter.pressOversampling == 0b000)						//disabling the pressure measurement function
 	{
 		return 0;
@@ -355,32 +366,9 @@ float BlueDot_BME280_TSL2591::readPressure(void)
 	
 	else
 	{
-		readTempC();
-		
-		int32_t adc_P;
-		adc_P = (uint32_t)readByte(BME280_PRESSURE_MSB) << 12;
-		adc_P |= (uint32_t)readByte(BME280_PRESSURE_LSB) << 4;
-		adc_P |= (readByte(BME280_PRESSURE_XLSB) >> 4 )& 0b00001111;
-		
-		int64_t var1, var2, P;
-		var1 = ((int64_t)t_fine) - 128000;
-		var2 = var1 * var1 * (int64_t)bme280_coefficients.dig_P6;
-		var2 = var2 + ((var1 * (int64_t)bme280_coefficients.dig_P5)<<17);
-		var2 = var2 + (((int64_t)bme280_coefficients.dig_P4)<<35);
-		var1 = ((var1 * var1 * (int64_t)bme280_coefficients.dig_P3)>>8) + ((var1 * (int64_t)bme280_coefficients.dig_P2)<<12);
-		var1 = (((((int64_t)1)<<47)+var1))*((int64_t)bme280_coefficients.dig_P1)>>33;
-		if (var1 == 0)
-		{
-			return 0; // avoid exception caused by division by zero
-		}
-		P = 1048576 - adc_P;
-		P = (((P << 31) - var2)*3125)/var1;
-		var1 = (((int64_t)bme280_coefficients.dig_P9) * (P >> 13) * (P >> 13)) >> 25;
-		var2 = (((int64_t)bme280_coefficients.dig_P8) * P) >> 19;
-		P = ((P + var1 + var2) >> 8) + (((int64_t)bme280_coefficients.dig_P7)<<4);
+		readTempC_Fixed();
 		
-		P = P >> 8; // /256
-		return (float)P/100;
+		return compensatePressure(readRawPressure());
 		
 	}
 }
@@ -433,10 +421,24 @@ float BlueDot_BME280_TSL2591::convertTempKelvin(void)
 //##########################################################################
 float BlueDot_BME280_TSL2591::readAltitudeFeet(void)
 {	
+	return calculateAltitudeFeet(readPressure());
+}
+
+//##########################################################################
+float BlueDot_BME280_TSL2591::readAltitudeMeter(void)
+{
+	return calculateAltitudeMeter(readPressure());
+}
+
+//##########################################################################
+float BlueDot_BME280_TSL2591::calculateAltitudeFeet(float pressure)
+{	
+	//Calculates the altitude from a pressure value (in hPa) that was already measured, e.g. with acquire()
+	
 	float heightOutput = 0;
 	float tempOutsideKelvin = convertTempKelvin();
 	
-	heightOutput = readPressure();
+	heightOutput = pressure;
 	heightOutput = (heightOutput/parameter.pressureSeaLevel);
 	heightOutput = pow(heightOutput, 0.190284);
 	heightOutput = 1 - heightOutput;
@@ -448,12 +450,14 @@ float BlueDot_BME280_TSL2591::readAltitudeFeet(void)
 }
 
 //##########################################################################
-float BlueDot_BME280_TSL2591::readAltitudeMeter(void)
+float BlueDot_BME280_TSL2591::calculateAltitudeMeter(float pressure)
 {
+	//Calculates the altitude from a pressure value (in hPa) that was already measured, e.g. with acquire()
+	
 	float heightOutput = 0;
 	float tempOutsideKelvin = convertTempKelvin();
 	
-	heightOutput = readPressure();
+	heightOutput = pressure;
 	heightOutput = (heightOutput/parameter.pressureSeaLevel);
 	heightOutput = pow(heightOutput, 0.190284);
 	heightOutput = 1 - heightOutput;	
@@ -466,6 +470,19 @@ float BlueDot_BME280_TSL2591::readAltitudeMeter(void)
 //##########################################################################
 float BlueDot_BME280_TSL2591::readHumidity(void)
 {
+	//The humidity is calculated in fixed-point by readHumidity_Fixed (Q22.10 format)
+	//Here we only convert it to %RH
+	
+	float H = readHumidity_Fixed();
+	H = H /1024.0;
+	return H;
+}
+//##########################################################################
+uint32_t BlueDot_BME280_TSL2591::readHumidity_Fixed(void)
+{
+	//Returns the relative humidity in Q22.10 format (i.e. 47445 = 47445/1024 = 46.333 %RH)
+	//The humidity compensation uses t_fine, so the temperature has to be read first
+	
 	if (parameter.humidOversampling == 0b000)					//disabling the humitidy measurement function
 	{
 		return 0;
@@ -473,27 +490,39 @@ float BlueDot_BME280_TSL2591::readHumidity(void)
 	
 	else
 	{
-		int32_t adc_H;
-		adc_H = (uint32_t)readByte(BME280_HUMIDITY_MSB) << 8;
-		adc_H |= (uint32_t)readByte(BME280_HUMIDITY_LSB);
-		
-		int32_t var1;
-		var1 = (t_fine - ((int32_t)76800));
-		var1 = (((((adc_H << 14) - (((int32_t)bme280_coefficients.dig_H4) << 20) - (((int32_t)bme280_coefficients.dig_H5) * var1)) +
-		((int32_t)16384)) >> 15) * (((((((var1 * ((int32_t)bme280_coefficients.dig_H6)) >> 10) * (((var1 * ((int32_t)bme280_coefficients.dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152)) *
-		((int32_t)bme280_coefficients.dig_H2) + 8192) >> 14));
-		var1 = (var1 - (((((var1 >> 15) * (var1 >> 15)) >> 7) * ((int32_t)bme280_coefficients.dig_H1)) >> 4));
-		var1 = (var1 < 0 ? 0 : var1);
-		var1 = (var1 > 419430400 ? 419430400 : var1);
-		float H = (var1>>12);
-		H = H /1024.0;
-		return H;
+		return compensateHumidity(readRawHumidity());
 	}
 }
 
 //##########################################################################
 float BlueDot_BME280_TSL2591::readTempC(void)
 {
+	//The temperature is calculated in fixed-point by readTempC_Fixed (in 0.01 °C)
+	
+	float T = readTempC_Fixed();
+	T = T / 100;
+	return T;
+}
+
+//##########################################################################
+float BlueDot_BME280_TSL2591::readTempF(void)
+{
+	if (parameter.tempOversampling == 0b000)				//disabling the temperature measurement function
+	{
+		return 0;
+	}	
+	
+	float T = readTempC_Fixed();
+	T = T / 100;
+	T = (T * 1.8) + 32;
+	return T;
+}
+
+//##########################################################################
+int32_t BlueDot_BME280_TSL2591::readTempC_Fixed(void)
+{
+	//Returns the temperature in 0.01 °C (i.e. 5123 = 51.23 °C)
+	//As a side effect t_fine is updated, which is needed for the pressure and humidity compensation
 	
 	if (parameter.tempOversampling == 0b000)					//disabling the temperature measurement function
 	{
@@ -502,49 +531,209 @@ float BlueDot_BME280_TSL2591::readTempC(void)
 	
 	else
 	{
-		int32_t adc_T;
-		adc_T = (uint32_t)readByte(BME280_TEMPERATURE_MSB) << 12;
-		adc_T |= (uint32_t)readByte(BME280_TEMPERATURE_LSB) << 4;
-		adc_T |= (readByte(BME280_TEMPERATURE_XLSB) >> 4 )& 0b00001111;
+		return compensateTemperature(readRawTemperature());
+	}
+}
+
+//##########################################################################
+int32_t BlueDot_BME280_TSL2591::readRawTemperature(void)
+{
+	//The raw temperature value (adc_T) is a 20-bit value stored in the registers 0xFA to 0xFC
+	
+	int32_t adc_T;
+	adc_T = (uint32_t)readByte(BME280_TEMPERATURE_MSB) << 12;
+	adc_T |= (uint32_t)readByte(BME280_TEMPERATURE_LSB) << 4;
+	adc_T |= (readByte(BME280_TEMPERATURE_XLSB) >> 4 )& 0b00001111;
+	return adc_T;
+}
+//##########################################################################
+int32_t BlueDot_BME280_TSL2591::readRawPressure(void)
+{
+	//The raw pressure value (adc_P) is a 20-bit value stored in the registers 0xF7 to 0xF9
+	
+	int32_t adc_P;
+	adc_P = (uint32_t)readByte(BME280_PRESSURE_MSB) << 12;
+	adc_P |= (uint32_t)readByte(BME280_PRESSURE_LSB) << 4;
+	adc_P |= (readByte(BME280_PRESSURE_XLSB) >> 4 )& 0b00001111;
+	return adc_P;
+}
+//##########################################################################
+int32_t BlueDot_BME280_TSL2591::readRawHumidity(void)
+{
+	//The raw humidity value (adc_H) is a 16-bit value stored in the registers 0xFD and 0xFE
+	
+	int32_t adc_H;
+	adc_H = (uint32_t)readByte(BME280_HUMIDITY_MSB) << 8;
+	adc_H |= (uint32_t)readByte(BME280_HUMIDITY_LSB);
+	return adc_H;
+}
+
+//##########################################################################
+//COMPENSATION FUNCTIONS - BME280
+//##########################################################################
+//These functions contain only the compensation formulas from the BME280 Datasheet
+//They do not access the I2C bus, so they can be checked against the Bosch reference code with any raw value
+int32_t BlueDot_BME280_TSL2591::compensateTemperature(int32_t adc_T)
+{
+	//Returns the temperature in 0.01 °C and updates t_fine
+	
+	int64_t var1, var2;
+	
+	var1 = ((((adc_T>>3) - ((int32_t)bme280_coefficients.dig_T1<<1))) * ((int32_t)bme280_coefficients.dig_T2)) >> 11;
+	var2 = (((((adc_T>>4) - ((int32_t)bme280_coefficients.dig_T1)) * ((adc_T>>4) - ((int32_t)bme280_coefficients.dig_T1))) >> 12) *
+	((int32_t)bme280_coefficients.dig_T3)) >> 14;
+	t_fine = var1 + var2;
+	return (t_fine * 5 + 128) >> 8;
+}
+//##########################################################################
+int32_t BlueDot_BME280_TSL2591::compensatePressure(int32_t adc_P)
+{
+	//Returns the pressure in Pa, using the t_fine value of the last temperature compensation
+	
+	int64_t var1, var2, P;
+	var1 = ((int64_t)t_fine) - 128000;
+	var2 = var1 * var1 * (int64_t)bme280_coefficients.dig_P6;
+	var2 = var2 + ((var1 * (int64_t)bme280_coefficients.dig_P5)<<17);
+	var2 = var2 + (((int64_t)bme280_coefficients.dig_P4)<<35);
+	var1 = ((var1 * var1 * (int64_t)bme280_coefficients.dig_P3)>>8) + ((var1 * (int64_t)bme280_coefficients.dig_P2)<<12);
+	var1 = (((((int64_t)1)<<47)+var1))*((int64_t)bme280_coefficients.dig_P1)>>33;
+	if (var1 == 0)
+	{
+		return 0; // avoid exception caused by division by zero
+	}
+	P = 1048576 - adc_P;
+	P = (((P << 31) - var2)*3125)/var1;
+	var1 = (((int64_t)bme280_coefficients.dig_P9) * (P >> 13) * (P >> 13)) >> 25;
+	var2 = (((int64_t)bme280_coefficients.dig_P8) * P) >> 19;
+	P = ((P + var1 + var2) >> 8) + (((int64_t)bme280_coefficients.dig_P7)<<4);
+	
+	P = P >> 8; // /256
+	return (int32_t)P;
+}
+//##########################################################################
+uint32_t BlueDot_BME280_TSL2591::compensateHumidity(int32_t adc_H)
+{
+	//Returns the relative humidity in Q22.10 format, using the t_fine value of the last temperature compensation
+	
+	int32_t var1;
+	var1 = (t_fine - ((int32_t)76800));
+	var1 = (((((adc_H << 14) - (((int32_t)bme280_coefficients.dig_H4) << 20) - (((int32_t)bme280_coefficients.dig_H5) * var1)) +
+	((int32_t)16384)) >> 15) * (((((((var1 * ((int32_t)bme280_coefficients.dig_H6)) >> 10) * (((var1 * ((int32_t)bme280_coefficients.dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152)) *
+	((int32_t)bme280_coefficients.dig_H2) + 8192) >> 14));
+	var1 = (var1 - (((((var1 >> 15) * (var1 >> 15)) >> 7) * ((int32_t)bme280_coefficients.dig_H1)) >> 4));
+	var1 = (var1 < 0 ? 0 : var1);
+	var1 = (var1 > 419430400 ? 419430400 : var1);
+	return (uint32_t)(var1>>12);
+}
+
+//##########################################################################
+//COMBINED ACQUISITION - BME280 + TSL2591
+//##########################################################################
+uint16_t BlueDot_BME280_TSL2591::getMeasurementTime_BME280(void)
+{
+	//Returns the maximum measurement time in ms for the current oversampling settings
+	//According to the BME280 Datasheet (chapter 9.1) the maximum measurement time is:
+	//t = 1.25 ms + 2.3 ms * osrs_t + (2.3 ms * osrs_p + 0.575 ms) + (2.3 ms * osrs_h + 0.575 ms)
+	//Here osrs_x is the oversampling factor (1, 2, 4, 8 or 16) and disabled measurements are skipped
+	
+	uint8_t oversampling[3] = {parameter.tempOversampling, parameter.pressOversampling, parameter.humidOversampling};
+	uint32_t time_us = 1250;
+	
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		uint8_t setting = oversampling[i] & 0b00000111;
+		if (setting == 0b000)
+		{
+			continue;
+		}
 		
-		int64_t var1, var2;
+		if (setting > 0b101)
+		{
+			setting = 0b101;
+		}
 		
-		var1 = ((((adc_T>>3) - ((int32_t)bme280_coefficients.dig_T1<<1))) * ((int32_t)bme280_coefficients.dig_T2)) >> 11;
-		var2 = (((((adc_T>>4) - ((int32_t)bme280_coefficients.dig_T1)) * ((adc_T>>4) - ((int32_t)bme280_coefficients.dig_T1))) >> 12) *
-		((int32_t)bme280_coefficients.dig_T3)) >> 14;
-		t_fine = var1 + var2;
-		float T = (t_fine * 5 + 128) >> 8;
-		T = T / 100;
-		return T;
+		time_us += 2300UL * (1 << (setting - 1));
+		if (i > 0)
+		{
+			time_us += 575;
+		}
 	}
+	
+	return (time_us + 999) / 1000;
 }
-
 //##########################################################################
-float BlueDot_BME280_TSL2591::readTempF(void)
+void BlueDot_BME280_TSL2591::acquire(BlueDot_BME280_TSL2591 &tsl2591, EnvironmentRecord &record)
 {
-	if (parameter.tempOversampling == 0b000)				//disabling the temperature measurement function
+	//This function is called with the BME280 object and takes the TSL2591 object as argument
+	//Both sensors convert independently from each other, so we start both measurements at the same time
+	//Then we wait only once for the slower device, instead of waiting for both devices one after the other
+	
+	uint32_t start = millis();
+	record.scheduled = start;
+	record.jitter = 0;
+	
+	//First we power the TSL2591 ON, which starts the integration of both photodiode channels
+	//The integration time is the same as in getFullLuminosity_TSL2591 (120 ms per step)
+	tsl2591.enable_TSL2591();
+	uint32_t deadline = start + 120UL * ((uint8_t)tsl2591.parameter.integration + 1);
+	
+	//In forced mode (0b01 or 0b10) writing the CTRL_MEAS register starts a single measurement of the BME280
+	//In sleep mode (0b00) we start a forced measurement for this cycle only, afterwards the BME280 returns to sleep mode
+	//In normal mode (0b11) the BME280 measures continually, so the latest data is already available
+	uint8_t mode = parameter.sensorMode & 0b00000011;
+	if (mode != 0b11)
 	{
-		return 0;
-	}	
+		uint8_t sensorMode = parameter.sensorMode;
+		if (mode == 0b00)
+		{
+			parameter.sensorMode = 0b01;
+		}
+		writeCTRLMeas();
+		parameter.sensorMode = sensorMode;
+		
+		uint32_t deadline_BME280 = start + getMeasurementTime_BME280();
+		
+		if ((int32_t)(deadline_BME280 - deadline) > 0)
+		{
+			deadline = deadline_BME280;
+		}
+	}
 	
-	else
+	int32_t remaining = (int32_t)(deadline - millis());
+	if (remaining > 0)
+	{
+		delay(remaining);
+	}
+	
+	record.timestamp = millis();
+	
+	//The values are stored in the same units as the fixed-point readers:
+	//temperature in 0.01 °C, pressure in Pa and humidity in Q22.10 format (%RH * 1024)
+	//Pressure and humidity compensation need t_fine from this temperature measurement
+	//So if the temperature measurement is disabled, pressure and humidity are set to 0 as well
+	record.temperature = 0;
+	record.pressure = 0;
+	record.humidity = 0;
+	
+	if (parameter.tempOversampling != 0b000)
 	{
-		int32_t adc_T;
-		adc_T = (uint32_t)readByte(BME280_TEMPERATURE_MSB) << 12;
-		adc_T |= (uint32_t)readByte(BME280_TEMPERATURE_LSB) << 4;
-		adc_T |= (readByte(BME280_TEMPERATURE_XLSB) >> 4 )& 0b00001111;
+		record.temperature = compensateTemperature(readRawTemperature());
 		
-		int64_t var1, var2;
+		if (parameter.pressOversampling != 0b000)
+		{
+			record.pressure = compensatePressure(readRawPressure());
+		}
 		
-		var1 = ((((adc_T>>3) - ((int32_t)bme280_coefficients.dig_T1<<1))) * ((int32_t)bme280_coefficients.dig_T2)) >> 11;
-		var2 = (((((adc_T>>4) - ((int32_t)bme280_coefficients.dig_T1)) * ((adc_T>>4) - ((int32_t)bme280_coefficients.dig_T1))) >> 12) *
-		((int32_t)bme280_coefficients.dig_T3)) >> 14;
-		t_fine = var1 + var2;
-		float T = (t_fine * 5 + 128) >> 8;
-		T = T / 100;
-		T = (T * 1.8) + 32;
-		return T;
+		if (parameter.humidOversampling != 0b000)
+		{
+			record.humidity = compensateHumidity(readRawHumidity());
+		}
 	}
+	
+	//Finally we read both photodiode channels and power the TSL2591 OFF
+	record.fullSpectrum = tsl2591.readByte16(TSL2591_COMMAND_BIT | TSL2591_NORMAL_MODE | TSL2591_C0DATAL_ADDR);
+	record.infrared = tsl2591.readByte16(TSL2591_COMMAND_BIT | TSL2591_NORMAL_MODE | TSL2591_C1DATAL_ADDR);
+	tsl2591.disable_TSL2591();
 }
 
 //##########################################################################
@@ -591,4 +780,290 @@ uint16_t BlueDot_BME280_TSL2591::readByte16(byte reg)
 	
 	return value1;
 	
-}
\ No newline at end of file
+}
+//##########################################################################
+//REPORTING FUNCTIONS - DEADBAND CHANGE DETECTION
+//##########################################################################
+BlueDot_Report::BlueDot_Report()
+{
+	for (uint8_t ch = 0; ch < REPORT_CHANNELS; ch++)
+	{
+		reset(ch);
+	}
+}
+//##########################################################################
+void BlueDot_Report::setDeadband(uint8_t ch, uint32_t absolute, uint16_t relative, uint32_t maxSilence)
+{
+	//Each channel (temperature, pressure, humidity and lux) has its own deadband
+	//The values are compared in the units of the fixed-point readers:
+	//REPORT_TEMPERATURE:	readTempC_Fixed()		(0.01 °C)
+	//REPORT_PRESSURE:		readPressure_Fixed()	(Pa)
+	//REPORT_HUMIDITY:		readHumidity_Fixed()	(1/1024 %RH)
+	//REPORT_LUX:			getFullSpectrum_TSL2591()	(raw counts)
+	
+	//absolute:		a new value is reported when it differs by more than this from the last reported value
+	//relative:		same as absolute, but in 1/1000 of the last reported value (the larger of both is used)
+	//maxSilence:	a value is reported anyway after this many milliseconds without a report (0 = never)
+	
+	if (ch >= REPORT_CHANNELS)
+	{
+		return;
+	}
+	
+	channel[ch].absoluteDeadband = absolute;
+	channel[ch].relativeDeadband = relative;
+	channel[ch].maxSilence = maxSilence;
+	reset(ch);
+}
+//##########################################################################
+void BlueDot_Report::reset(uint8_t ch)
+{
+	//After a reset the next value on this channel is always reported
+	
+	if (ch >= REPORT_CHANNELS)
+	{
+		return;
+	}
+	
+	channel[ch].reported = false;
+}
+//##########################################################################
+bool BlueDot_Report::check(uint8_t ch, int32_t value)
+{
+	return check(ch, value, millis());
+}
+//##########################################################################
+bool BlueDot_Report::check(uint8_t ch, int32_t value, uint32_t now)
+{
+	//Returns true if the value should be transmitted, and then stores it as the last reported value
+	//The deadband threshold is calculated only once per report, so each sample costs one subtraction and two comparisons
+	
+	if (ch >= REPORT_CHANNELS)
+	{
+		return false;
+	}
+	
+	ReportChannel &c = channel[ch];
+	
+	if (c.reported)
+	{
+		uint32_t difference;
+		if (value >= c.lastReported)
+		{
+			difference = (uint32_t)value - (uint32_t)c.lastReported;
+		}
+		else
+		{
+			difference = (uint32_t)c.lastReported - (uint32_t)value;
+		}
+		
+		bool silenceExpired = (c.maxSilence != 0) && ((uint32_t)(now - c.lastReportTime) >= c.maxSilence);
+		
+		if (difference <= c.threshold && !silenceExpired)
+		{
+			return false;
+		}
+	}
+	
+	uint32_t magnitude = (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+	uint32_t relativeThreshold = ((uint64_t)magnitude * c.relativeDeadband) / 1000;
+	
+	c.threshold = (relativeThreshold > c.absoluteDeadband) ? relativeThreshold : c.absoluteDeadband;
+	c.lastReported = value;
+	c.lastReportTime = now;
+	c.reported = true;
+	return true;
+}
+//##########################################################################
+//FILTER FUNCTIONS - MEDIAN AND DECIMATION
+//##########################################################################
+BlueDot_Filter::BlueDot_Filter()
+{
+	setFilter(1, 1);
+}
+//##########################################################################
+void BlueDot_Filter::setFilter(uint8_t median, uint8_t decimate)
+{
+	//The filter runs on integer samples of any channel, i.e. raw ADC values or the results of the fixed-point readers
+	//Each sample goes through two stages:
+	//1. Median of the last "median" samples (1 to FILTER_MAX_MEDIAN, 1 = off), which removes single spikes
+	//2. Average of "decimate" consecutive median values (1 to 255, 1 = off), with one output per "decimate" samples
+	//So we can sample fast with low hardware oversampling and still get a clean output at a lower rate
+	//The sum of the averaged values must fit into 32 bits, which is always the case for BME280 and TSL2591 values
+	
+	if (median < 1)
+	{
+		median = 1;
+	}
+	
+	if (median > FILTER_MAX_MEDIAN)
+	{
+		median = FILTER_MAX_MEDIAN;
+	}
+	
+	if (decimate < 1)
+	{
+		decimate = 1;
+	}
+	
+	medianLength = median;
+	decimation = decimate;
+	reset();
+}
+//##########################################################################
+void BlueDot_Filter::reset(void)
+{
+	output = 0;
+	bufferCount = 0;
+	bufferPosition = 0;
+	sum = 0;
+	sumCount = 0;
+}
+//##########################################################################
+bool BlueDot_Filter::add(int32_t sample)
+{
+	//Returns true when a new filtered value is available in "output"
+	//No memory is allocated, the last samples are kept in a small ring buffer
+	
+	buffer[bufferPosition] = sample;
+	bufferPosition++;
+	if (bufferPosition >= medianLength)
+	{
+		bufferPosition = 0;
+	}
+	
+	if (bufferCount < medianLength)
+	{
+		bufferCount++;
+	}
+	
+	//For the median we sort a copy of the buffer with insertion sort, which is fast for up to 9 values
+	//Until the buffer is full, the median is taken from the samples we have so far
+	int32_t value = sample;
+	
+	if (bufferCount > 1)
+	{
+		int32_t sorted[FILTER_MAX_MEDIAN];
+		
+		for (uint8_t i = 0; i < bufferCount; i++)
+		{
+			int32_t x = buffer[i];
+			uint8_t j = i;
+			
+			while (j > 0 && sorted[j - 1] > x)
+			{
+				sorted[j] = sorted[j - 1];
+				j--;
+			}
+			sorted[j] = x;
+		}
+		
+		value = sorted[bufferCount / 2];
+	}
+	
+	sum += value;
+	sumCount++;
+	
+	if (sumCount < decimation)
+	{
+		return false;
+	}
+	
+	//Rounding to the nearest integer, also for negative values
+	if (sum >= 0)
+	{
+		output = (sum + decimation / 2) / decimation;
+	}
+	else
+	{
+		output = (sum - decimation / 2) / decimation;
+	}
+	
+	sum = 0;
+	sumCount = 0;
+	return true;
+}
+
+//##########################################################################
+//SAMPLER FUNCTIONS - FIXED-RATE SAMPLING
+//##########################################################################
+BlueDot_Sampler::BlueDot_Sampler()
+{
+	begin(1000, SAMPLER_CATCH_UP);
+}
+//##########################################################################
+void BlueDot_Sampler::begin(uint32_t periodMs, uint8_t overrunPolicy)
+{
+	//The sampler keeps a fixed sampling period by scheduling every sample relative to the previous deadline
+	//Unlike delay(), the time needed for reading the sensors and printing the results does not add to the period
+	//If a sample is late by more than one period (overrun), there are two options:
+	//SAMPLER_CATCH_UP:	all missed samples are taken one after the other, until the sampler is back on schedule
+	//SAMPLER_SKIP:		the missed samples are dropped (and counted in "skipped"), the late sample is taken on the latest point of the original time grid
+	
+	if (periodMs < 1)
+	{
+		periodMs = 1;
+	}
+	
+	period = periodMs;
+	policy = overrunPolicy;
+	deadline = 0;
+	scheduled = 0;
+	jitter = 0;
+	skipped = 0;
+	started = false;
+}
+//##########################################################################
+bool BlueDot_Sampler::ready(void)
+{
+	return ready(millis());
+}
+//##########################################################################
+bool BlueDot_Sampler::ready(uint32_t now)
+{
+	//Returns true when the next sample is due, without blocking
+	//Then "scheduled" holds the planned time of this sample and "jitter" the delay in ms
+	//All time differences are calculated with unsigned integers, so the millis() overflow is handled correctly
+	
+	if (!started)
+	{
+		deadline = now;
+		started = true;
+	}
+	
+	if ((int32_t)(now - deadline) < 0)
+	{
+		return false;
+	}
+	
+	scheduled = deadline;
+	
+	//With SAMPLER_SKIP the sample is moved to the last point of the time grid at or before "now"
+	//All points of the time grid from the missed deadline up to this point are skipped
+	if (policy == SAMPLER_SKIP && (now - deadline) >= period)
+	{
+		uint32_t missed = (now - deadline) / period;
+		scheduled += missed * period;
+		skipped += missed;
+	}
+	
+	jitter = (int32_t)(now - scheduled);
+	deadline = scheduled + period;
+	return true;
+}
+//##########################################################################
+bool BlueDot_Sampler::sample(BlueDot_BME280_TSL2591 &bme280, BlueDot_BME280_TSL2591 &tsl2591, EnvironmentRecord &record)
+{
+	//When the next sample is due, both sensors are read with acquire()
+	//The record is stamped with the planned sample time and the jitter
+	
+	if (!ready())
+	{
+		return false;
+	}
+	
+	bme280.acquire(tsl2591, record);
+	record.scheduled = scheduled;
+	record.jitter = jitter;
+	return true;
+}
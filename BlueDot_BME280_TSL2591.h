@@ -115,6 +115,50 @@ struct DeviceParameter
 };
 
 
+enum ReportChannels
+{
+	REPORT_TEMPERATURE	=		0,
+	REPORT_PRESSURE		=		1,
+	REPORT_HUMIDITY		=		2,
+	REPORT_LUX			=		3,
+	REPORT_CHANNELS		=		4,
+};
+
+
+enum SamplerPolicies
+{
+	SAMPLER_CATCH_UP	=		0,
+	SAMPLER_SKIP		=		1,
+};
+
+
+struct EnvironmentRecord
+{
+	uint32_t timestamp;
+	uint32_t scheduled;
+	int32_t jitter;
+	int32_t temperature;
+	int32_t pressure;
+	uint32_t humidity;
+	uint16_t fullSpectrum;
+	uint16_t infrared;
+	
+};
+
+
+struct ReportChannel
+{
+	int32_t lastReported;
+	uint32_t lastReportTime;
+	uint32_t threshold;
+	uint32_t absoluteDeadband = 0;
+	uint16_t relativeDeadband = 0;
+	uint32_t maxSilence = 0;
+	bool reported = false;
+	
+};
+
+
 class BlueDot_BME280_TSL2591 
 {
  public: 
@@ -151,10 +195,83 @@ class BlueDot_BME280_TSL2591
   float readTempC(void);
   float readTempF(void);
   float readHumidity(void);
+  int32_t readPressure_Fixed(void);
+  int32_t readTempC_Fixed(void);
+  uint32_t readHumidity_Fixed(void);
+  int32_t compensateTemperature(int32_t adc_T);
+  int32_t compensatePressure(int32_t adc_P);
+  uint32_t compensateHumidity(int32_t adc_H);
+  int32_t readRawTemperature(void);
+  int32_t readRawPressure(void);
+  int32_t readRawHumidity(void);
   float readAltitudeFeet(void);
   float readAltitudeMeter(void);
+  float calculateAltitudeFeet(float pressure);
+  float calculateAltitudeMeter(float pressure);
   float convertTempKelvin(void);
+  
+  uint16_t getMeasurementTime_BME280(void);
+  void acquire(BlueDot_BME280_TSL2591 &tsl2591, EnvironmentRecord &record);
+
+};
 
+
+class BlueDot_Report
+{
+ public:
+ 
+  ReportChannel channel[REPORT_CHANNELS];
+  
+  BlueDot_Report();
+  void setDeadband(uint8_t ch, uint32_t absolute, uint16_t relative, uint32_t maxSilence);
+  bool check(uint8_t ch, int32_t value);
+  bool check(uint8_t ch, int32_t value, uint32_t now);
+  void reset(uint8_t ch);
+  
+};
+
+
+#define FILTER_MAX_MEDIAN		9
+
+class BlueDot_Filter
+{
+ public:
+ 
+  uint8_t medianLength;
+  uint8_t decimation;
+  int32_t output;
+  int32_t buffer[FILTER_MAX_MEDIAN];
+  uint8_t bufferCount;
+  uint8_t bufferPosition;
+  int32_t sum;
+  uint8_t sumCount;
+  
+  BlueDot_Filter();
+  void setFilter(uint8_t median, uint8_t decimate);
+  bool add(int32_t sample);
+  void reset(void);
+  
+};
+
+
+class BlueDot_Sampler
+{
+ public:
+ 
+  uint32_t period;
+  uint8_t policy;
+  uint32_t deadline;
+  uint32_t scheduled;
+  int32_t jitter;
+  uint32_t skipped;
+  bool started;
+  
+  BlueDot_Sampler();
+  void begin(uint32_t periodMs, uint8_t overrunPolicy);
+  bool ready(void);
+  bool ready(uint32_t now);
+  bool sample(BlueDot_BME280_TSL2591 &bme280, BlueDot_BME280_TSL2591 &tsl2591, EnvironmentRecord &record);
+  
 };
 
 
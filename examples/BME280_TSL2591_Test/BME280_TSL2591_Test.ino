@@ -17,6 +17,8 @@
 #include "BlueDot_BME280_TSL2591.h"
 BlueDot_BME280_TSL2591 bme280;
 BlueDot_BME280_TSL2591 tsl2591;
+BlueDot_Sampler sampler;
+EnvironmentRecord record;
 
 
 void setup() {
@@ -207,6 +209,15 @@ void setup() {
     Serial.println(F("TSL2591 detected!"));
   }
   
+  //*********************************************************************
+  //*************SAMPLING RATE*******************************************
+  
+  //The sampler keeps a fixed sampling period, independent of how long the measurements and the Serial output take
+  //If a measurement takes longer than one period, SAMPLER_SKIP drops the missed samples
+  //Use SAMPLER_CATCH_UP instead to take all missed samples as fast as possible
+  
+    sampler.begin(1000, SAMPLER_SKIP);                     //one sample every 1000 ms
+  
   Serial.println();
   Serial.println(); 
 }
@@ -214,29 +225,39 @@ void setup() {
   //*************NOW LET'S START MEASURING*******************************
 void loop() 
 { 
+   //sampler.sample() returns false until the next sample is due
+   //Then both sensors are measured at the same time with acquire() and the results are stored in the record
+   if (!sampler.sample(bme280, tsl2591, record))
+   {
+     return;
+   }
      
    Serial.print(F("Duration in Seconds:\t\t"));
-   Serial.println(float(millis())/1000);
+   Serial.println(float(record.timestamp)/1000);
+
+   Serial.print(F("Scheduled in Seconds:\t\t"));
+   Serial.println(float(record.scheduled)/1000);
+
+   Serial.print(F("Jitter in Milliseconds:\t\t"));
+   Serial.println(record.jitter);
  
+   //The record holds the fixed-point values: temperature in 0.01 °C, pressure in Pa and humidity in %RH * 1024
    Serial.print(F("Temperature in Celsius:\t\t")); 
-   Serial.println(bme280.readTempC());
+   Serial.println(float(record.temperature)/100);
    
    Serial.print(F("Humidity in %:\t\t\t")); 
-   Serial.println(bme280.readHumidity());
+   Serial.println(float(record.humidity)/1024);
 
    Serial.print(F("Pressure in hPa:\t\t")); 
-   Serial.println(bme280.readPressure());
+   Serial.println(float(record.pressure)/100);
 
    Serial.print(F("Altitude in Meters:\t\t")); 
-   Serial.println(bme280.readAltitudeMeter());
+   Serial.println(bme280.calculateAltitudeMeter(record.pressure/100.0));
 
    Serial.print(F("Illuminance in Lux:\t\t")); 
-   Serial.println(tsl2591.readIlluminance_TSL2591());
+   Serial.println(tsl2591.calculateLux_TSL2591(record.fullSpectrum, record.infrared));
 
    Serial.println();
    Serial.println();
-   
-
-   delay(1000);   
  
 }
@@ -0,0 +1,17 @@
+#include "BlueDot_BME280_TSL2591.h"
+#include "BoschReference.h"
+
+BME280_Coefficients ref_coefficients;
+BME280_S32_t t_fine;
+
+//The Datasheet gives no humidity example, so the first set uses typical humidity coefficients
+//Order: T1, T2, T3, P1 ... P9, H1 ... H6
+const BME280_Coefficients coefficientSets[] =
+{
+	{27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000, 75, 363, 0, 313, 50, 30},
+	{28269, 26435, 50, 37093, -10657, 3024, 8147, -62, -7, 9900, -10230, 4285, 75, 362, 0, 333, 48, 30},
+	{27858, 26542, -1000, 36741, -10561, 3024, 6823, -142, -7, 12300, -12000, 5000, 75, 366, 0, 309, 50, 30},
+	{28416, 26718, 50, 38143, -10487, 3024, 5736, 41, -7, 9900, -10230, 4285, 75, 372, 0, 291, 50, 30},
+};
+
+const uint8_t coefficientSetCount = sizeof(coefficientSets) / sizeof(coefficientSets[0]);
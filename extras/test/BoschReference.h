@@ -0,0 +1,111 @@
+//Reference compensation routines from the Bosch BME280 Datasheet (chapters 4.2.3 and 8.2)
+//They are copied without changes (apart from the coefficient access), so the library kernels can be checked against them
+//BlueDot_BME280_TSL2591.h has to be included before this file
+
+#ifndef BOSCH_REFERENCE_H
+#define BOSCH_REFERENCE_H
+
+#include <stdint.h>
+
+typedef int32_t BME280_S32_t;
+typedef uint32_t BME280_U32_t;
+typedef int64_t BME280_S64_t;
+
+extern BME280_Coefficients ref_coefficients;
+extern BME280_S32_t t_fine;
+
+//Calibration data of real devices, the first set contains the example values from the Datasheet (chapter 8.2)
+extern const BME280_Coefficients coefficientSets[];
+extern const uint8_t coefficientSetCount;
+
+#define dig_T1 ref_coefficients.dig_T1
+#define dig_T2 ref_coefficients.dig_T2
+#define dig_T3 ref_coefficients.dig_T3
+#define dig_P1 ref_coefficients.dig_P1
+#define dig_P2 ref_coefficients.dig_P2
+#define dig_P3 ref_coefficients.dig_P3
+#define dig_P4 ref_coefficients.dig_P4
+#define dig_P5 ref_coefficients.dig_P5
+#define dig_P6 ref_coefficients.dig_P6
+#define dig_P7 ref_coefficients.dig_P7
+#define dig_P8 ref_coefficients.dig_P8
+#define dig_P9 ref_coefficients.dig_P9
+#define dig_H1 ref_coefficients.dig_H1
+#define dig_H2 ref_coefficients.dig_H2
+#define dig_H3 ref_coefficients.dig_H3
+#define dig_H4 ref_coefficients.dig_H4
+#define dig_H5 ref_coefficients.dig_H5
+#define dig_H6 ref_coefficients.dig_H6
+
+//Returns temperature in DegC, resolution is 0.01 DegC. Output value of "5123" equals 51.23 DegC.
+//t_fine carries fine temperature as global value
+inline BME280_S32_t BME280_compensate_T_int32(BME280_S32_t adc_T)
+{
+	BME280_S32_t var1, var2, T;
+	var1 = ((((adc_T>>3) - ((BME280_S32_t)dig_T1<<1))) * ((BME280_S32_t)dig_T2)) >> 11;
+	var2 = (((((adc_T>>4) - ((BME280_S32_t)dig_T1)) * ((adc_T>>4) - ((BME280_S32_t)dig_T1))) >> 12) *
+	((BME280_S32_t)dig_T3)) >> 14;
+	t_fine = var1 + var2;
+	T = (t_fine * 5 + 128) >> 8;
+	return T;
+}
+
+//Returns pressure in Pa as unsigned 32 bit integer in Q24.8 format (24 integer bits and 8 fractional bits).
+//Output value of "24674867" represents 24674867/256 = 96386.2 Pa = 963.862 hPa
+inline BME280_U32_t BME280_compensate_P_int64(BME280_S32_t adc_P)
+{
+	BME280_S64_t var1, var2, p;
+	var1 = ((BME280_S64_t)t_fine) - 128000;
+	var2 = var1 * var1 * (BME280_S64_t)dig_P6;
+	var2 = var2 + ((var1*(BME280_S64_t)dig_P5)<<17);
+	var2 = var2 + (((BME280_S64_t)dig_P4)<<35);
+	var1 = ((var1 * var1 * (BME280_S64_t)dig_P3)>>8) + ((var1 * (BME280_S64_t)dig_P2)<<12);
+	var1 = (((((BME280_S64_t)1)<<47)+var1))*((BME280_S64_t)dig_P1)>>33;
+	if (var1 == 0)
+	{
+		return 0; // avoid exception caused by division by zero
+	}
+	p = 1048576-adc_P;
+	p = (((p<<31)-var2)*3125)/var1;
+	var1 = (((BME280_S64_t)dig_P9) * (p>>13) * (p>>13)) >> 25;
+	var2 = (((BME280_S64_t)dig_P8) * p) >> 19;
+	p = ((p + var1 + var2) >> 8) + (((BME280_S64_t)dig_P7)<<4);
+	return (BME280_U32_t)p;
+}
+
+//Returns humidity in %RH as unsigned 32 bit integer in Q22.10 format (22 integer and 10 fractional bits).
+//Output value of "47445" represents 47445/1024 = 46.333 %RH
+inline BME280_U32_t bme280_compensate_H_int32(BME280_S32_t adc_H)
+{
+	BME280_S32_t v_x1_u32r;
+	v_x1_u32r = (t_fine - ((BME280_S32_t)76800));
+	v_x1_u32r = (((((adc_H << 14) - (((BME280_S32_t)dig_H4) << 20) - (((BME280_S32_t)dig_H5) * v_x1_u32r)) +
+	((BME280_S32_t)16384)) >> 15) * (((((((v_x1_u32r * ((BME280_S32_t)dig_H6)) >> 10) * (((v_x1_u32r *
+	((BME280_S32_t)dig_H3)) >> 11) + ((BME280_S32_t)32768))) >> 10) + ((BME280_S32_t)2097152)) *
+	((BME280_S32_t)dig_H2) + 8192) >> 14));
+	v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((BME280_S32_t)dig_H1)) >> 4));
+	v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
+	v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r);
+	return (BME280_U32_t)(v_x1_u32r>>12);
+}
+
+#undef dig_T1
+#undef dig_T2
+#undef dig_T3
+#undef dig_P1
+#undef dig_P2
+#undef dig_P3
+#undef dig_P4
+#undef dig_P5
+#undef dig_P6
+#undef dig_P7
+#undef dig_P8
+#undef dig_P9
+#undef dig_H1
+#undef dig_H2
+#undef dig_H3
+#undef dig_H4
+#undef dig_H5
+#undef dig_H6
+
+#endif
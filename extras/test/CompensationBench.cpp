@@ -0,0 +1,51 @@
+//Measures the time per sample of the BME280 compensation kernels on the host
+//Each kernel runs over its full ADC range for every coefficient set
+
+#include <stdio.h>
+#include <chrono>
+
+#include "BlueDot_BME280_TSL2591.h"
+#include "BoschReference.h"
+
+static volatile uint32_t sink;
+
+template <typename Kernel>
+static double measure(Kernel kernel, int32_t range)
+{
+	const uint8_t rounds = 8;
+	uint32_t sum = 0;
+	
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (uint8_t round = 0; round < rounds; round++)
+	{
+		for (int32_t adc = 0; adc < range; adc++)
+		{
+			sum += (uint32_t)kernel(adc);
+		}
+	}
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	sink = sum;
+	return std::chrono::duration<double, std::nano>(stop - start).count() / ((double)range * rounds);
+}
+
+int main(void)
+{
+	BlueDot_BME280_TSL2591 bme280;
+	
+	printf("set  T [ns/sample]  P [ns/sample]  H [ns/sample]\n");
+	
+	for (uint8_t set = 0; set < coefficientSetCount; set++)
+	{
+		bme280.bme280_coefficients = coefficientSets[set];
+		
+		double timeT = measure([&](int32_t adc) { return bme280.compensateTemperature(adc); }, 1L << 20);
+		bme280.t_fine = 128000;
+		double timeP = measure([&](int32_t adc) { return bme280.compensatePressure(adc); }, 1L << 20);
+		double timeH = measure([&](int32_t adc) { return bme280.compensateHumidity(adc); }, 1L << 16);
+		
+		printf("%3u  %13.2f  %13.2f  %13.2f\n", set, timeT, timeP, timeH);
+	}
+	
+	return 0;
+}
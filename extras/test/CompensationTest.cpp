@@ -0,0 +1,211 @@
+//Checks the BME280 compensation kernels of the library against the Bosch reference routines
+//For every coefficient set the full 20-bit adc_T range is checked
+//The full 20-bit adc_P and 16-bit adc_H ranges are checked at several t_fine values (-40 °C to 85 °C)
+//The readers (readTempC, readPressure, ...) are checked with register values from the Wire stub
+//The program returns a non-zero value if any result differs from the reference
+
+#include <stdio.h>
+
+#include "BlueDot_BME280_TSL2591.h"
+#include "BoschReference.h"
+#include "Wire.h"
+
+//t_fine is about 5120 * temperature in °C
+static const int32_t tFineValues[] = {-204800, -51200, 0, 76800, 128000, 256000, 435200};
+
+static unsigned long mismatches = 0;
+
+static void reportMismatch(const char *kernel, uint8_t set, int32_t tFine, int32_t adc, long result, long expected)
+{
+	if (mismatches < 10)
+	{
+		printf("MISMATCH %s: set %u, t_fine %ld, adc %ld: library %ld, reference %ld\n", kernel, set, (long)tFine, (long)adc, result, expected);
+	}
+	mismatches++;
+}
+
+static void writeRegisters(int32_t adc_T, int32_t adc_P, int32_t adc_H)
+{
+	//The lower nibble of the XLSB registers is not part of the value, so we fill it with ones
+	wireRegisters[BME280_PRESSURE_MSB] = adc_P >> 12;
+	wireRegisters[BME280_PRESSURE_LSB] = (adc_P >> 4) & 0xFF;
+	wireRegisters[BME280_PRESSURE_XLSB] = ((adc_P & 0x0F) << 4) | 0x0F;
+	wireRegisters[BME280_TEMPERATURE_MSB] = adc_T >> 12;
+	wireRegisters[BME280_TEMPERATURE_LSB] = (adc_T >> 4) & 0xFF;
+	wireRegisters[BME280_TEMPERATURE_XLSB] = ((adc_T & 0x0F) << 4) | 0x0F;
+	wireRegisters[BME280_HUMIDITY_MSB] = adc_H >> 8;
+	wireRegisters[BME280_HUMIDITY_LSB] = adc_H & 0xFF;
+}
+
+static void checkReaders(BlueDot_BME280_TSL2591 &bme280, uint8_t set)
+{
+	//The raw values are taken from a simple pseudo random sequence, together with the limits of each range
+	uint32_t random = 12345;
+	
+	bme280.parameter.tempOversampling = 0b101;
+	bme280.parameter.pressOversampling = 0b101;
+	bme280.parameter.humidOversampling = 0b101;
+	
+	for (uint16_t i = 0; i < 4096; i++)
+	{
+		int32_t adc_T, adc_P, adc_H;
+		
+		if (i < 2)
+		{
+			adc_T = i ? 0xFFFFF : 0;
+			adc_P = i ? 0xFFFFF : 0;
+			adc_H = i ? 0xFFFF : 0;
+		}
+		else
+		{
+			random = random * 1103515245 + 12345;
+			adc_T = (random >> 8) & 0xFFFFF;
+			random = random * 1103515245 + 12345;
+			adc_P = (random >> 8) & 0xFFFFF;
+			adc_H = (random >> 12) & 0xFFFF;
+		}
+		
+		writeRegisters(adc_T, adc_P, adc_H);
+		
+		//1. Assembling the raw values from the MSB, LSB and XLSB registers
+		if (bme280.readRawTemperature() != adc_T)
+		{
+			reportMismatch("readRawTemperature", set, 0, adc_T, bme280.readRawTemperature(), adc_T);
+		}
+		if (bme280.readRawPressure() != adc_P)
+		{
+			reportMismatch("readRawPressure", set, 0, adc_P, bme280.readRawPressure(), adc_P);
+		}
+		if (bme280.readRawHumidity() != adc_H)
+		{
+			reportMismatch("readRawHumidity", set, 0, adc_H, bme280.readRawHumidity(), adc_H);
+		}
+		
+		//2. Fixed-point readers against the reference
+		int32_t expectedT = BME280_compensate_T_int32(adc_T);
+		int32_t expectedP = (int32_t)BME280_compensate_P_int64(adc_P) >> 8;
+		uint32_t expectedH = bme280_compensate_H_int32(adc_H);
+		
+		int32_t fixedT = bme280.readTempC_Fixed();
+		if (fixedT != expectedT)
+		{
+			reportMismatch("readTempC_Fixed", set, t_fine, adc_T, fixedT, expectedT);
+		}
+		
+		int32_t fixedP = bme280.readPressure_Fixed();
+		if (fixedP != expectedP)
+		{
+			reportMismatch("readPressure_Fixed", set, t_fine, adc_P, fixedP, expectedP);
+		}
+		
+		uint32_t fixedH = bme280.readHumidity_Fixed();
+		if (fixedH != expectedH)
+		{
+			reportMismatch("readHumidity_Fixed", set, t_fine, adc_H, fixedH, expectedH);
+		}
+		
+		//3. Float readers: fixed-point result / 100 (°C, hPa) or / 1024 (%RH), and °F = °C * 1.8 + 32
+		float tempC = bme280.readTempC();
+		if (tempC != (float)fixedT / 100)
+		{
+			reportMismatch("readTempC", set, t_fine, adc_T, (long)(tempC * 100), fixedT);
+		}
+		
+		float tempF = bme280.readTempF();
+		if (tempF != (float)(tempC * 1.8 + 32))
+		{
+			reportMismatch("readTempF", set, t_fine, adc_T, (long)(tempF * 100), (long)((tempC * 1.8 + 32) * 100));
+		}
+		
+		float pressure = bme280.readPressure();
+		if (pressure != (float)fixedP / 100)
+		{
+			reportMismatch("readPressure", set, t_fine, adc_P, (long)(pressure * 100), fixedP);
+		}
+		
+		float humidity = bme280.readHumidity();
+		if (humidity != (float)fixedH / 1024)
+		{
+			reportMismatch("readHumidity", set, t_fine, adc_H, (long)(humidity * 1024), fixedH);
+		}
+	}
+	
+	//4. Disabled measurements return 0
+	bme280.parameter.tempOversampling = 0b000;
+	bme280.parameter.pressOversampling = 0b000;
+	bme280.parameter.humidOversampling = 0b000;
+	
+	if (bme280.readTempC() != 0 || bme280.readTempF() != 0 || bme280.readPressure() != 0 || bme280.readHumidity() != 0)
+	{
+		reportMismatch("disabled readers", set, 0, 0, 1, 0);
+	}
+}
+
+int main(void)
+{
+	BlueDot_BME280_TSL2591 bme280;
+	
+	//The worked example from the Datasheet (chapter 8.2): adc_T = 519888 gives 25.08 °C, adc_P = 415148 gives 100653 Pa
+	bme280.bme280_coefficients = coefficientSets[0];
+	if (bme280.compensateTemperature(519888) != 2508)
+	{
+		reportMismatch("T (Datasheet example)", 0, bme280.t_fine, 519888, bme280.compensateTemperature(519888), 2508);
+	}
+	if (bme280.compensatePressure(415148) != 100653)
+	{
+		reportMismatch("P (Datasheet example)", 0, bme280.t_fine, 415148, bme280.compensatePressure(415148), 100653);
+	}
+	
+	for (uint8_t set = 0; set < coefficientSetCount; set++)
+	{
+		bme280.bme280_coefficients = coefficientSets[set];
+		ref_coefficients = coefficientSets[set];
+		
+		//1. Temperature: the returned value and t_fine must both match
+		for (int32_t adc_T = 0; adc_T < (1L << 20); adc_T++)
+		{
+			int32_t result = bme280.compensateTemperature(adc_T);
+			int32_t expected = BME280_compensate_T_int32(adc_T);
+			
+			if (result != expected || bme280.t_fine != t_fine)
+			{
+				reportMismatch("T", set, bme280.t_fine, adc_T, result, expected);
+			}
+		}
+		
+		checkReaders(bme280, set);
+		
+		for (uint8_t i = 0; i < sizeof(tFineValues) / sizeof(tFineValues[0]); i++)
+		{
+			bme280.t_fine = tFineValues[i];
+			t_fine = tFineValues[i];
+			
+			//2. Pressure: the library returns Pa, the reference returns Pa in Q24.8 format
+			for (int32_t adc_P = 0; adc_P < (1L << 20); adc_P++)
+			{
+				int32_t result = bme280.compensatePressure(adc_P);
+				int32_t expected = (int32_t)BME280_compensate_P_int64(adc_P) >> 8;
+				
+				if (result != expected)
+				{
+					reportMismatch("P", set, t_fine, adc_P, result, expected);
+				}
+			}
+			
+			//3. Humidity: both return %RH in Q22.10 format
+			for (int32_t adc_H = 0; adc_H < (1L << 16); adc_H++)
+			{
+				uint32_t result = bme280.compensateHumidity(adc_H);
+				uint32_t expected = bme280_compensate_H_int32(adc_H);
+				
+				if (result != expected)
+				{
+					reportMismatch("H", set, t_fine, adc_H, result, expected);
+				}
+			}
+		}
+	}
+	
+	printf("%u coefficient sets, %u t_fine values: %lu mismatches\n", coefficientSetCount, (unsigned)(sizeof(tFineValues) / sizeof(tFineValues[0])), mismatches);
+	return mismatches == 0 ? 0 : 1;
+}
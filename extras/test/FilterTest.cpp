@@ -0,0 +1,81 @@
+//Checks the median and decimation stages of BlueDot_Filter
+//The program returns a non-zero value if any check fails
+
+#include <stdio.h>
+
+#include "BlueDot_BME280_TSL2591.h"
+
+static unsigned long failures = 0;
+
+static void check(bool condition, const char *description)
+{
+	if (!condition)
+	{
+		printf("FAILED: %s\n", description);
+		failures++;
+	}
+}
+
+int main(void)
+{
+	BlueDot_Filter filter;
+	
+	//1. Default setup: every sample is passed through unchanged
+	check(filter.medianLength == 1 && filter.decimation == 1, "default setup");
+	check(filter.add(-7) && filter.output == -7, "default pass-through");
+	
+	//2. Warm-up: until the buffer is full, the median is taken from the samples we have so far
+	//With an even number of samples the upper of the two middle values is used
+	filter.setFilter(3, 1);
+	check(filter.add(10) && filter.output == 10, "warm-up with one sample");
+	check(filter.add(20) && filter.output == 20, "warm-up with two samples");
+	check(filter.bufferCount == 2, "warm-up buffer count");
+	check(filter.add(15) && filter.output == 15, "buffer full");
+	
+	//3. Single spikes are removed by the median of 3
+	filter.setFilter(3, 1);
+	const int32_t spikes[] = {100, 100, 9000, 100, -9000, 100, 101, 100};
+	const int32_t expected[] = {100, 100, 100, 100, 100, 100, 100, 100};
+	for (uint8_t i = 0; i < sizeof(spikes) / sizeof(spikes[0]); i++)
+	{
+		check(filter.add(spikes[i]) && filter.output == expected[i], "spike rejection");
+	}
+	
+	//4. Decimation: one rounded average for every N samples, also for negative values
+	filter.setFilter(1, 4);
+	check(!filter.add(1) && !filter.add(2) && !filter.add(3), "no output before N samples");
+	check(filter.add(4) && filter.output == 3, "positive average 2.5 is rounded to 3");
+	check(!filter.add(-1) && !filter.add(-2) && !filter.add(-3), "no output before N samples (negative)");
+	check(filter.add(-4) && filter.output == -3, "negative average -2.5 is rounded to -3");
+	
+	filter.setFilter(1, 3);
+	filter.add(-1);
+	filter.add(-1);
+	check(filter.add(-2) && filter.output == -1, "negative average -1.33 is rounded to -1");
+	filter.add(-2);
+	filter.add(-2);
+	check(filter.add(-1) && filter.output == -2, "negative average -1.67 is rounded to -2");
+	
+	//5. Median and decimation together
+	filter.setFilter(5, 3);
+	const int32_t samples[] = {100, 100, 9000, 100, 100, 100, -9000, 100, 100};
+	uint8_t outputs = 0;
+	for (uint8_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++)
+	{
+		if (filter.add(samples[i]))
+		{
+			check(filter.output == 100, "median and decimation");
+			outputs++;
+		}
+	}
+	check(outputs == 3, "one output for every 3 samples");
+	
+	//6. Limits of the setup
+	filter.setFilter(0, 0);
+	check(filter.medianLength == 1 && filter.decimation == 1, "setFilter(0, 0) is clamped to (1, 1)");
+	filter.setFilter(10, 5);
+	check(filter.medianLength == FILTER_MAX_MEDIAN && filter.decimation == 5, "setFilter(10, 5) is clamped to FILTER_MAX_MEDIAN");
+	
+	printf("filter: %lu failures\n", failures);
+	return failures == 0 ? 0 : 1;
+}
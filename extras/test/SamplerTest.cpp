@@ -0,0 +1,58 @@
+//Checks the scheduling of BlueDot_Sampler, including the millis() overflow and both overrun policies
+//The time is passed to ready(now) directly, so no real time passes
+//The program returns a non-zero value if any check fails
+
+#include <stdio.h>
+
+#include "BlueDot_BME280_TSL2591.h"
+
+static unsigned long failures = 0;
+
+static void check(bool condition, const char *description)
+{
+	if (!condition)
+	{
+		printf("FAILED: %s\n", description);
+		failures++;
+	}
+}
+
+int main(void)
+{
+	BlueDot_Sampler sampler;
+	
+	//1. Regular sampling across the millis() overflow (0xFFFFFFFF -> 0)
+	uint32_t base = 0xFFFFFF80;
+	sampler.begin(100, SAMPLER_CATCH_UP);
+	check(sampler.ready(base) && sampler.scheduled == base && sampler.jitter == 0, "first sample is taken at once");
+	check(!sampler.ready(base + 99), "no sample before the deadline");
+	check(sampler.ready(base + 103), "sample after the overflow");
+	check(sampler.scheduled == base + 100 && sampler.jitter == 3, "scheduled time and jitter after the overflow");
+	check(!sampler.ready(base + 199), "no sample before the next deadline");
+	check(sampler.ready(base + 200) && sampler.jitter == 0, "next sample stays on the time grid");
+	
+	//2. SAMPLER_CATCH_UP: the missed samples are taken one after the other
+	check(sampler.ready(base + 550) && sampler.scheduled == base + 300 && sampler.jitter == 250, "catch-up: first missed sample");
+	check(sampler.ready(base + 550) && sampler.scheduled == base + 400 && sampler.jitter == 150, "catch-up: second missed sample");
+	check(sampler.ready(base + 550) && sampler.scheduled == base + 500 && sampler.jitter == 50, "catch-up: third missed sample");
+	check(!sampler.ready(base + 550), "catch-up: back on schedule");
+	check(sampler.skipped == 0, "catch-up: nothing is skipped");
+	
+	//3. SAMPLER_SKIP: the late sample is taken on the latest point of the time grid, the points before it are skipped
+	base = 0xFFFFF000;
+	sampler.begin(1000, SAMPLER_SKIP);
+	check(sampler.ready(base), "skip: first sample");
+	check(sampler.ready(base + 1000) && sampler.skipped == 0, "skip: sample on time");
+	check(sampler.ready(base + 4500), "skip: late sample across the overflow");
+	check(sampler.scheduled == base + 4000 && sampler.jitter == 500 && sampler.skipped == 2, "skip: late sample on the latest grid point");
+	check(!sampler.ready(base + 4999), "skip: no sample before the next deadline");
+	check(sampler.ready(base + 5000) && sampler.jitter == 0, "skip: back on the time grid");
+	check(sampler.ready(base + 6999) && sampler.scheduled == base + 6000 && sampler.jitter == 999 && sampler.skipped == 2, "skip: less than one period late");
+	
+	//4. Limits of the setup
+	sampler.begin(0, SAMPLER_CATCH_UP);
+	check(sampler.period == 1, "begin(0) is clamped to 1 ms");
+	
+	printf("sampler: %lu failures\n", failures);
+	return failures == 0 ? 0 : 1;
+}
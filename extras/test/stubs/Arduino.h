@@ -0,0 +1,14 @@
+//Minimal Arduino core for compiling the library on a host computer (extras/test only)
+
+#ifndef ARDUINO_STUB_H
+#define ARDUINO_STUB_H
+
+#include <stdint.h>
+#include <math.h>
+
+typedef uint8_t byte;
+
+uint32_t millis(void);
+void delay(uint32_t ms);
+
+#endif
@@ -0,0 +1,58 @@
+#include <chrono>
+#include <thread>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+TwoWire Wire;
+uint8_t wireRegisters[256];
+
+static uint8_t wireRegister = 0;
+static bool wireRegisterSelected = false;
+
+uint32_t millis(void)
+{
+	static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void delay(uint32_t ms)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+	(void)address;
+	wireRegisterSelected = false;
+}
+
+uint8_t TwoWire::endTransmission(void)
+{
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(int address, int quantity)
+{
+	(void)address;
+	return (uint8_t)quantity;
+}
+
+int TwoWire::read(void)
+{
+	return wireRegisters[wireRegister++];
+}
+
+int TwoWire::write(uint8_t value)
+{
+	if (!wireRegisterSelected)
+	{
+		wireRegister = value;
+		wireRegisterSelected = true;
+	}
+	else
+	{
+		wireRegisters[wireRegister++] = value;
+	}
+	return 1;
+}
@@ -0,0 +1,26 @@
+//Minimal Wire library for compiling the library on a host computer (extras/test only)
+//There is no I2C bus on the host, so the register contents are taken from the table wireRegisters
+//Like on the real devices, the first byte written selects the register, further bytes are written to the table
+//and every read returns the selected register and moves on to the next one
+
+#ifndef WIRE_STUB_H
+#define WIRE_STUB_H
+
+#include <stdint.h>
+
+class TwoWire
+{
+ public:
+ 
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(void);
+  uint8_t requestFrom(int address, int quantity);
+  int read(void);
+  int write(uint8_t value);
+  
+};
+
+extern TwoWire Wire;
+extern uint8_t wireRegisters[256];
+
+#endif